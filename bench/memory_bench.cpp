@@ -0,0 +1,174 @@
+// Heap bytes and allocation count of parsed responses, json::value against
+// PokeapiCompact. Bytes are what callers requested from operator new, so
+// malloc's own per-block overhead, which favours fewer allocations, is not
+// included. Resident set growth is shown for reference. Each layout runs in
+// its own process from the same starting state, so neither inherits pages
+// the allocator kept from the other.
+//
+//   g++ -std=c++11 -O2 -I../src -o memory_bench memory_bench.cpp -lcpprest -lssl -lcrypto -lpthread -lboost_system
+//   ./memory_bench json                   # synthetic /pokemon/{id} responses
+//   ./memory_bench compact
+//   ./memory_bench json pokeapi.snap      # every resource in a snapshot
+//   ./memory_bench compact pokeapi.snap
+
+#include "PokeapiIntern.h"
+#include "PokeapiSnapshot.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <unistd.h>
+
+// Every heap block carries its size in front so live bytes can be tracked
+static size_t live_bytes = 0;
+static size_t live_allocations = 0;
+static size_t total_allocations = 0;
+
+static const size_t prefix = alignof(std::max_align_t);
+
+void* operator new(size_t size) {
+    char* block = static_cast<char*>(std::malloc(size + prefix));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    live_bytes += size;
+    live_allocations++;
+    total_allocations++;
+    return block + prefix;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    char* block = static_cast<char*>(pointer) - prefix;
+    live_bytes -= *reinterpret_cast<size_t*>(block);
+    live_allocations--;
+    std::free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, size_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { operator delete(pointer); }
+
+struct usage {
+    size_t bytes;
+    size_t live;
+    size_t total;
+    size_t resident;
+};
+
+static size_t resident_bytes() {
+    size_t pages = 0;
+    size_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+static usage now() {
+    return usage{live_bytes, live_allocations, total_allocations, resident_bytes()};
+}
+
+static json::value reference(const std::string& family, int id, const std::string& name) {
+    json::value result;
+    result[U("name")] = json::value::string(utility::conversions::to_string_t(name));
+    result[U("url")] = json::value::string(utility::conversions::to_string_t(
+        "https://pokeapi.co/api/v2/" + family + "/" + std::to_string(id) + "/"));
+    return result;
+}
+
+// Same shape and repetition as a real /pokemon/{id} body
+static json::value synthetic_pokemon(int id) {
+    json::value pokemon;
+    pokemon[U("id")] = json::value::number(id);
+    pokemon[U("name")] = json::value::string(utility::conversions::to_string_t("pokemon-" + std::to_string(id)));
+    pokemon[U("species")] = reference("pokemon-species", id, "pokemon-" + std::to_string(id));
+
+    json::value moves = json::value::array();
+    for (int m = 0; m < 80; m++) {
+        int move_id = (id * 7 + m * 13) % 900 + 1;
+        json::value move;
+        move[U("move")] = reference("move", move_id, "move-" + std::to_string(move_id));
+        json::value details = json::value::array();
+        for (int v = 0; v < 10; v++) {
+            json::value detail;
+            detail[U("level_learned_at")] = json::value::number(m % 50);
+            detail[U("move_learn_method")] = reference("move-learn-method", 1 + m % 4, "method-" + std::to_string(m % 4));
+            detail[U("version_group")] = reference("version-group", v + 1, "version-group-" + std::to_string(v + 1));
+            details[v] = detail;
+        }
+        move[U("version_group_details")] = details;
+        moves[m] = move;
+    }
+    pokemon[U("moves")] = moves;
+
+    json::value game_indices = json::value::array();
+    for (int g = 0; g < 20; g++) {
+        json::value index;
+        index[U("game_index")] = json::value::number(id);
+        index[U("version")] = reference("version", g + 1, "version-" + std::to_string(g + 1));
+        game_indices[g] = index;
+    }
+    pokemon[U("game_indices")] = game_indices;
+    return pokemon;
+}
+
+static void report(const char* label, const usage& before, const usage& after) {
+    std::printf("%-22s %15zu %16zu %18zu %14zu\n", label, after.bytes - before.bytes, after.live - before.live,
+                after.total - before.total, after.resident > before.resident ? after.resident - before.resident : 0);
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode != "json" && mode != "compact") {
+        std::fprintf(stderr, "usage: %s json|compact [snapshot]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> endpoints;
+    std::unique_ptr<PokeapiSnapshot> snapshot;
+    if (argc > 2) {
+        snapshot.reset(new PokeapiSnapshot(argv[2]));
+        endpoints = snapshot->endpoints();
+    } else {
+        for (int id = 1; id <= 200; id++) {
+            endpoints.push_back("/pokemon/" + std::to_string(id));
+        }
+    }
+
+    // Inputs are built first in both modes so only the conversion is counted
+    std::vector<json::value> inputs;
+    inputs.reserve(endpoints.size());
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        inputs.push_back(snapshot ? snapshot->get(endpoints[i]) : synthetic_pokemon(static_cast<int>(i + 1)));
+    }
+
+    std::printf("%zu responses\n", endpoints.size());
+    std::printf("%-22s %15s %16s %18s %14s\n", "", "requested bytes", "live allocations", "total allocations", "rss growth");
+
+    usage before = now();
+    if (mode == "json") {
+        // json::value copies are deep, so this is one more parsed response each
+        std::vector<json::value> parsed;
+        parsed.reserve(inputs.size());
+        for (const auto& input : inputs) {
+            parsed.push_back(input);
+        }
+        report("json::value", before, now());
+    } else {
+        auto table = std::make_shared<PokeapiInternTable>();
+        std::vector<PokeapiCompact> compact;
+        compact.reserve(inputs.size());
+        for (const auto& input : inputs) {
+            compact.emplace_back(input, table);
+        }
+        report("PokeapiCompact", before, now());
+        std::printf("%zu interned strings, %zu bytes of string data\n", table->size(), table->bytes());
+    }
+
+    return 0;
+}
@@ -0,0 +1,442 @@
+#ifndef POKEAPI_INTERN_H
+#define POKEAPI_INTERN_H
+
+#include <cpprest/json.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace web;
+
+// Shared table of names and resource URLs.
+// Every distinct string is stored once and referred to by a compact id, so
+// the thousands of repeated "name"/"url" pairs in a response cost 4 bytes
+// each instead of a heap allocation each. The table only grows, so it is
+// meant for that bounded vocabulary, not for free text. Safe to share
+// between threads: intern() and find() take a mutex, lookup() and size()
+// are lock-free.
+class PokeapiInternTable {
+private:
+    static const size_t chunk_bits = 12;
+    static const size_t chunk_size = size_t(1) << chunk_bits;
+    static const size_t max_chunks = 4096;
+
+    mutable std::mutex lock;
+    std::unordered_map<std::string, uint32_t> ids;
+    size_t string_bytes = 0;
+
+    // Append-only id -> string storage; chunks never move once published
+    std::atomic<const std::string**> chunks[max_chunks];
+    std::atomic<uint32_t> count{0};
+
+public:
+    PokeapiInternTable() {
+        for (auto& chunk : chunks) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~PokeapiInternTable() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    PokeapiInternTable(const PokeapiInternTable&) = delete;
+    PokeapiInternTable& operator=(const PokeapiInternTable&) = delete;
+
+    uint32_t intern(const std::string& text) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = ids.find(text);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        uint32_t id = count.load(std::memory_order_relaxed);
+        size_t chunk = id >> chunk_bits;
+        if (chunk >= max_chunks) {
+            throw std::length_error("PokeapiInternTable is full");
+        }
+        const std::string** slots = chunks[chunk].load(std::memory_order_relaxed);
+        if (!slots) {
+            slots = new const std::string*[chunk_size];
+            chunks[chunk].store(slots, std::memory_order_release);
+        }
+        auto inserted = ids.emplace(text, id).first;
+        slots[id & (chunk_size - 1)] = &inserted->first;
+        string_bytes += text.size();
+        count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // Id of an already interned string, without adding it
+    bool find(const std::string& text, uint32_t& id) const {
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = ids.find(text);
+        if (found == ids.end()) {
+            return false;
+        }
+        id = found->second;
+        return true;
+    }
+
+    const std::string& lookup(uint32_t id) const {
+        if (id >= count.load(std::memory_order_acquire)) {
+            throw std::out_of_range("Unknown interned string id " + std::to_string(id));
+        }
+        return *chunks[id >> chunk_bits].load(std::memory_order_acquire)[id & (chunk_size - 1)];
+    }
+
+    size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    // Total characters stored, excluding per-string overhead
+    size_t bytes() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return string_bytes;
+    }
+};
+
+// Bump allocator for the decoded data of one response.
+// Memory is taken from the heap in blocks that double up to block_size, so
+// small responses stay small, and is released all at once when the arena
+// goes away; nothing is freed individually.
+class PokeapiArena {
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t block_size;
+    size_t block_used = 0;
+    size_t block_capacity = 0;
+    size_t reserved = 0;
+    size_t used = 0;
+
+    void add_block(size_t size) {
+        blocks.emplace_back(new char[size]);
+        block_capacity = size;
+        block_used = 0;
+        reserved += size;
+    }
+
+public:
+    explicit PokeapiArena(size_t block_size = 16 * 1024) : block_size(block_size) {}
+    PokeapiArena(const PokeapiArena&) = delete;
+    PokeapiArena& operator=(const PokeapiArena&) = delete;
+    PokeapiArena(PokeapiArena&&) = default;
+    PokeapiArena& operator=(PokeapiArena&&) = default;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        size_t start = (block_used + alignment - 1) & ~(alignment - 1);
+        if (blocks.empty() || start + size > block_capacity) {
+            // new[] returns memory aligned for any fundamental type
+            size_t next = blocks.empty() ? 1024 : std::min(block_capacity * 2, block_size);
+            add_block(std::max(size, next));
+            start = 0;
+        }
+        block_used = start + size;
+        used += size;
+        return blocks.back().get() + start;
+    }
+
+    template <typename T>
+    T* allocate_array(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    size_t bytes_reserved() const { return reserved; }
+    size_t bytes_used() const { return used; }
+    size_t block_count() const { return blocks.size(); }
+};
+
+// A parsed response decoded into an arena.
+// Object keys and "name"/"url" values are interned in the shared table;
+// every other string, such as flavor text, is copied into the arena and
+// freed with it. Build one from the json::value a get_* call returns and
+// drop the json::value; read it back through get() or copy it out with
+// to_json().
+class PokeapiCompact {
+public:
+    // string_node is interned, text_node lives in the arena
+    enum node_type : uint8_t { null_node, bool_node, int_node, uint_node, double_node, string_node, text_node, array_node, object_node };
+
+    static const uint32_t no_key = 0xFFFFFFFF;
+
+private:
+    struct node {
+        node_type type;
+        uint32_t key;
+        uint32_t count;
+        union {
+            bool boolean;
+            int64_t integer;
+            uint64_t unsigned_integer;
+            double real;
+            uint32_t string_id;
+            const char* text;
+            const node* children;
+        };
+    };
+
+    std::shared_ptr<PokeapiInternTable> table;
+    PokeapiArena arena;
+    node* root;
+
+    static bool is_reference_field(const std::string& key) {
+        return key == "name" || key == "url";
+    }
+
+    // Length-prefixed copy in the arena
+    const char* copy_text(const std::string& text) {
+        uint32_t length = static_cast<uint32_t>(text.size());
+        char* stored = static_cast<char*>(arena.allocate(sizeof(length) + text.size(), alignof(uint32_t)));
+        std::memcpy(stored, &length, sizeof(length));
+        std::memcpy(stored + sizeof(length), text.data(), text.size());
+        return stored;
+    }
+
+    void fill(node& entry, const json::value& value, bool intern_string = false) {
+        entry.count = 0;
+        entry.integer = 0;
+        switch (value.type()) {
+        case json::value::Boolean:
+            entry.type = bool_node;
+            entry.boolean = value.as_bool();
+            break;
+        case json::value::Number: {
+            const json::number& number = value.as_number();
+            if (number.is_int64()) {
+                entry.type = int_node;
+                entry.integer = number.to_int64();
+            } else if (number.is_uint64()) {
+                entry.type = uint_node;
+                entry.unsigned_integer = number.to_uint64();
+            } else {
+                entry.type = double_node;
+                entry.real = number.to_double();
+            }
+            break;
+        }
+        case json::value::String:
+            if (intern_string) {
+                entry.type = string_node;
+                entry.string_id = table->intern(utility::conversions::to_utf8string(value.as_string()));
+            } else {
+                entry.type = text_node;
+                entry.text = copy_text(utility::conversions::to_utf8string(value.as_string()));
+            }
+            break;
+        case json::value::Array: {
+            const json::array& items = value.as_array();
+            node* children = arena.allocate_array<node>(items.size());
+            entry.type = array_node;
+            entry.count = static_cast<uint32_t>(items.size());
+            entry.children = children;
+            for (const auto& item : items) {
+                children->key = no_key;
+                fill(*children++, item);
+            }
+            break;
+        }
+        case json::value::Object: {
+            const json::object& members = value.as_object();
+            node* children = arena.allocate_array<node>(members.size());
+            entry.type = object_node;
+            entry.count = static_cast<uint32_t>(members.size());
+            entry.children = children;
+            for (const auto& member : members) {
+                std::string key = utility::conversions::to_utf8string(member.first);
+                children->key = table->intern(key);
+                fill(*children++, member.second, is_reference_field(key));
+            }
+            break;
+        }
+        default:
+            entry.type = null_node;
+            break;
+        }
+    }
+
+public:
+    // Read-only view of one node; valid while its PokeapiCompact lives
+    class view {
+    private:
+        const PokeapiInternTable* table;
+        const node* entry;
+
+        static void type_error(const char* expected) {
+            throw std::runtime_error(std::string("compact node is not ") + expected);
+        }
+
+        // Compares through lock-free lookups; objects are small
+        const node* find_field(const std::string& name) const {
+            if (entry->type != object_node) {
+                return nullptr;
+            }
+            for (uint32_t i = 0; i < entry->count; i++) {
+                if (table->lookup(entry->children[i].key) == name) {
+                    return entry->children + i;
+                }
+            }
+            return nullptr;
+        }
+
+    public:
+        view(const PokeapiInternTable* table, const node* entry) : table(table), entry(entry) {}
+
+        node_type type() const { return entry->type; }
+        bool is_null() const { return entry->type == null_node; }
+        bool is_object() const { return entry->type == object_node; }
+        bool is_array() const { return entry->type == array_node; }
+        bool is_string() const { return entry->type == string_node || entry->type == text_node; }
+        bool is_bool() const { return entry->type == bool_node; }
+
+        bool is_number() const {
+            return entry->type == int_node || entry->type == uint_node || entry->type == double_node;
+        }
+
+        size_t size() const {
+            return (is_array() || is_object()) ? entry->count : 0;
+        }
+
+        bool as_bool() const {
+            if (!is_bool()) {
+                type_error("a boolean");
+            }
+            return entry->boolean;
+        }
+
+        // Unsigned values are returned only when they fit
+        int64_t as_integer() const {
+            if (entry->type == uint_node && entry->unsigned_integer <= uint64_t(INT64_MAX)) {
+                return static_cast<int64_t>(entry->unsigned_integer);
+            }
+            if (entry->type != int_node) {
+                type_error("an integer");
+            }
+            return entry->integer;
+        }
+
+        double as_double() const {
+            if (entry->type == int_node) {
+                return static_cast<double>(entry->integer);
+            }
+            if (entry->type == uint_node) {
+                return static_cast<double>(entry->unsigned_integer);
+            }
+            if (entry->type != double_node) {
+                type_error("a number");
+            }
+            return entry->real;
+        }
+
+        // Interned id, shared by equal names and urls across every response
+        // using the same table; no_key for strings held in the arena
+        uint32_t string_id() const {
+            if (entry->type != string_node) {
+                return no_key;
+            }
+            return entry->string_id;
+        }
+
+        std::string as_string() const {
+            if (!is_string()) {
+                type_error("a string");
+            }
+            if (entry->type == text_node) {
+                uint32_t length;
+                std::memcpy(&length, entry->text, sizeof(length));
+                return std::string(entry->text + sizeof(length), length);
+            }
+            return table->lookup(entry->string_id);
+        }
+
+        uint32_t key_id() const { return entry->key; }
+
+        std::string key() const {
+            return entry->key == no_key ? std::string() : table->lookup(entry->key);
+        }
+
+        view at(size_t index) const {
+            if (index >= size()) {
+                throw std::out_of_range("compact node index out of range");
+            }
+            return view(table, entry->children + index);
+        }
+
+        bool has_field(const std::string& name) const {
+            return find_field(name) != nullptr;
+        }
+
+        view at(const std::string& name) const {
+            const node* found = find_field(name);
+            if (!found) {
+                throw std::out_of_range("compact object has no field " + name);
+            }
+            return view(table, found);
+        }
+
+        json::value to_json() const {
+            switch (entry->type) {
+            case bool_node:
+                return json::value::boolean(entry->boolean);
+            case int_node:
+                return json::value::number(entry->integer);
+            case uint_node:
+                return json::value::number(entry->unsigned_integer);
+            case double_node:
+                return json::value::number(entry->real);
+            case string_node:
+            case text_node:
+                return json::value::string(utility::conversions::to_string_t(as_string()));
+            case array_node: {
+                json::value result = json::value::array(entry->count);
+                for (size_t i = 0; i < entry->count; i++) {
+                    result[i] = at(i).to_json();
+                }
+                return result;
+            }
+            case object_node: {
+                json::value result = json::value::object();
+                for (size_t i = 0; i < entry->count; i++) {
+                    view member = at(i);
+                    result[utility::conversions::to_string_t(member.key())] = member.to_json();
+                }
+                return result;
+            }
+            default:
+                return json::value::null();
+            }
+        }
+    };
+
+    PokeapiCompact(const json::value& value, std::shared_ptr<PokeapiInternTable> table, size_t block_size = 16 * 1024)
+        : table(table), arena(block_size) {
+        root = arena.allocate_array<node>(1);
+        root->key = no_key;
+        fill(*root, value);
+    }
+
+    PokeapiCompact(PokeapiCompact&&) = default;
+    PokeapiCompact& operator=(PokeapiCompact&&) = default;
+
+    view get() const {
+        return view(table.get(), root);
+    }
+
+    json::value to_json() const {
+        return get().to_json();
+    }
+
+    const PokeapiArena& memory() const {
+        return arena;
+    }
+};
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef POKEAPI_SIDECAR_H
+#define POKEAPI_SIDECAR_H
+
+#include "Pokeapi.h"
+#include "PokeapiSnapshot.h"
+#include <cpprest/http_listener.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace web::http::experimental::listener;
+
+// Background refresh settings for PokeapiSidecar.
+// Expired entries are served stale for up to stale_for while a refresh runs.
+// Entries read at least hot_hits times since their last fetch are refreshed
+// refresh_ahead before they expire, at a random extra offset of up to jitter.
+// All refreshes share a budget of upstream_budget requests per second.
+// Upstream 404s are cached for not_found_ttl and never served stale.
+struct refresh_options {
+    std::chrono::seconds stale_for = std::chrono::hours(24);
+    std::chrono::seconds refresh_ahead = std::chrono::minutes(5);
+    std::chrono::seconds jitter = std::chrono::minutes(1);
+    unsigned hot_hits = 10;
+    double upstream_budget = 5;
+    std::chrono::milliseconds interval = std::chrono::seconds(1);
+    std::chrono::seconds not_found_ttl = std::chrono::minutes(1);
+};
+
+// Local caching proxy shared by every process on a host.
+// Serves the same /api/v2/... paths as pokeapi.co from one in-memory cache,
+// and collapses concurrent misses for the same path into a single upstream
+// request. Point workers at it with Pokeapi("http://127.0.0.1:8080/api/v2").
+// Upstream status codes are passed through to workers unchanged. All upstream
+// traffic goes through one long-lived client and its connection pool.
+// Callers do not wait on upstream for a cached path until it is older than
+// ttl + stale_for; see refresh_options.
+class PokeapiSidecar {
+private:
+    struct cache_entry {
+        json::value body;
+        std::chrono::steady_clock::time_point fetched;
+        std::chrono::steady_clock::time_point refresh_at;
+        unsigned hits;
+        http::status_code status;
+    };
+
+    Pokeapi upstream;
+    http_listener listener;
+    std::chrono::seconds ttl;
+    refresh_options refresh;
+    std::mutex lock;
+    std::map<std::string, cache_entry> cache;
+    std::map<std::string, pplx::task<json::value>> in_flight;
+    std::unique_ptr<PokeapiSnapshot> snapshot;
+
+    // Entries by refresh_at, so the scheduler only looks at what is due.
+    // Superseded items are skipped when their refresh_at no longer matches.
+    std::multimap<std::chrono::steady_clock::time_point, std::string> refresh_queue;
+
+    // Entries by the time they may no longer be served: ttl + stale_for for
+    // resources, not_found_ttl for 404s. Matched against fetched the same way.
+    std::multimap<std::chrono::steady_clock::time_point, std::pair<std::string, std::chrono::steady_clock::time_point>> expiry_queue;
+
+    std::thread scheduler;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::mt19937 random{std::random_device{}()};
+    double budget_tokens = 0;
+    std::chrono::steady_clock::time_point budget_refilled = std::chrono::steady_clock::now();
+
+    static bool is_error(const json::value& result) {
+        return result.has_field(U("success")) && !result.at(U("success")).as_bool();
+    }
+
+    // Upstream status carried in the error object; 502 when none was received
+    static http::status_code status_of(const json::value& result) {
+        if (!is_error(result)) {
+            return status_codes::OK;
+        }
+        if (result.has_field(U("status")) && result.at(U("status")).is_number()) {
+            return static_cast<http::status_code>(result.at(U("status")).as_integer());
+        }
+        return status_codes::BadGateway;
+    }
+
+    // Caller holds lock. Keeps the hit count, halved, so popularity decays
+    // across refreshes instead of resetting.
+    void store(const std::string& endpoint, const json::value& body, std::chrono::steady_clock::time_point fetched,
+               http::status_code status = status_codes::OK) {
+        std::uniform_int_distribution<long long> spread(0, refresh.jitter.count());
+        auto refresh_at = fetched + ttl - refresh.refresh_ahead - std::chrono::seconds(spread(random));
+        if (status != status_codes::OK) {
+            refresh_at = std::chrono::steady_clock::time_point::max();
+        }
+        auto existing = cache.find(endpoint);
+        unsigned hits = existing == cache.end() ? 0 : existing->second.hits / 2;
+        refresh_at = std::max(refresh_at, fetched);
+        cache[endpoint] = cache_entry{body, fetched, refresh_at, hits, status};
+        if (status == status_codes::OK) {
+            refresh_queue.emplace(refresh_at, endpoint);
+            expiry_queue.emplace(fetched + ttl + refresh.stale_for, std::make_pair(endpoint, fetched));
+        } else {
+            expiry_queue.emplace(fetched + refresh.not_found_ttl, std::make_pair(endpoint, fetched));
+        }
+    }
+
+    // Caller holds lock. Drops entries that fetch() would no longer serve
+    void evict(std::chrono::steady_clock::time_point now) {
+        auto last = expiry_queue.upper_bound(now);
+        for (auto item = expiry_queue.begin(); item != last; ++item) {
+            auto entry = cache.find(item->second.first);
+            if (entry != cache.end() && entry->second.fetched == item->second.second) {
+                cache.erase(entry);
+            }
+        }
+        expiry_queue.erase(expiry_queue.begin(), last);
+    }
+
+    // Caller holds lock. Token bucket shared by stale and ahead-of-expiry refreshes.
+    bool take_budget(std::chrono::steady_clock::time_point now) {
+        double elapsed = std::chrono::duration<double>(now - budget_refilled).count();
+        budget_refilled = now;
+        budget_tokens = std::min(std::max(1.0, refresh.upstream_budget),
+                                 budget_tokens + elapsed * refresh.upstream_budget);
+        if (budget_tokens < 1) {
+            return false;
+        }
+        budget_tokens -= 1;
+        return true;
+    }
+
+    // Caller holds lock. Starts an upstream fetch unless one is already running.
+    pplx::task<json::value> start_fetch(const std::string& endpoint) {
+        auto pending = in_flight.find(endpoint);
+        if (pending != in_flight.end()) {
+            return pending->second;
+        }
+
+        auto task = upstream.get_resource(endpoint)
+            .then([this, endpoint](json::value result) {
+                std::lock_guard<std::mutex> guard(lock);
+                http::status_code status = status_of(result);
+                if (status == status_codes::OK || status == status_codes::NotFound) {
+                    store(endpoint, result, std::chrono::steady_clock::now(), status);
+                }
+                in_flight.erase(endpoint);
+                return result;
+            });
+        in_flight[endpoint] = task;
+        return task;
+    }
+
+    pplx::task<json::value> fetch(const std::string& endpoint) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto now = std::chrono::steady_clock::now();
+
+        auto cached = cache.find(endpoint);
+        if (cached == cache.end() && snapshot && snapshot->contains(endpoint)) {
+            auto age = std::chrono::system_clock::now() - std::chrono::system_clock::from_time_t(snapshot->created());
+            store(endpoint, snapshot->get(endpoint), now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(age));
+            cached = cache.find(endpoint);
+        }
+
+        if (cached != cache.end()) {
+            cache_entry& entry = cached->second;
+            entry.hits++;
+            auto age = now - entry.fetched;
+            if (entry.status != status_codes::OK) {
+                if (age < refresh.not_found_ttl) {
+                    return pplx::task_from_result(entry.body);
+                }
+                return start_fetch(endpoint);
+            }
+            if (age < ttl) {
+                return pplx::task_from_result(entry.body);
+            }
+            if (age < ttl + refresh.stale_for) {
+                if (in_flight.find(endpoint) == in_flight.end() && take_budget(now)) {
+                    start_fetch(endpoint);
+                }
+                return pplx::task_from_result(entry.body);
+            }
+        }
+
+        return start_fetch(endpoint);
+    }
+
+    // Refreshes hot entries shortly before they expire, most read first,
+    // for as long as the budget allows, and evicts expired ones.
+    void schedule_refreshes() {
+        std::unique_lock<std::mutex> guard(lock);
+        while (!stopping) {
+            wake.wait_for(guard, refresh.interval);
+            if (stopping) {
+                break;
+            }
+
+            // Only due items are touched. Cold ones leave the queue and are
+            // refreshed on their next read instead.
+            auto now = std::chrono::steady_clock::now();
+            evict(now);
+            std::vector<std::pair<unsigned, std::string>> due;
+            auto last = refresh_queue.upper_bound(now);
+            for (auto item = refresh_queue.begin(); item != last; ++item) {
+                auto entry = cache.find(item->second);
+                if (entry != cache.end() && entry->second.refresh_at == item->first &&
+                    entry->second.hits >= refresh.hot_hits && in_flight.find(item->second) == in_flight.end()) {
+                    due.emplace_back(entry->second.hits, item->second);
+                }
+            }
+            refresh_queue.erase(refresh_queue.begin(), last);
+
+            std::sort(due.begin(), due.end(), [](const std::pair<unsigned, std::string>& a,
+                                                 const std::pair<unsigned, std::string>& b) {
+                return a.first > b.first;
+            });
+            for (const auto& entry : due) {
+                if (take_budget(now)) {
+                    start_fetch(entry.second);
+                } else {
+                    refresh_queue.emplace(cache[entry.second].refresh_at, entry.second);
+                }
+            }
+        }
+    }
+
+    // Completes once no upstream fetch is running. Their continuations
+    // capture this, so none may outlive the sidecar.
+    pplx::task<void> drain() {
+        std::vector<pplx::task<json::value>> pending;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (const auto& fetch : in_flight) {
+                pending.push_back(fetch.second);
+            }
+        }
+        if (pending.empty()) {
+            return pplx::task_from_result();
+        }
+        return pplx::when_all(pending.begin(), pending.end()).then([this](std::vector<json::value>) {
+            return drain();
+        });
+    }
+
+    void stop_scheduler() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (scheduler.joinable()) {
+            scheduler.join();
+        }
+    }
+
+    void handle_get(http_request request) {
+        std::string endpoint = utility::conversions::to_utf8string(request.relative_uri().to_string());
+        if (endpoint.empty() || endpoint[0] != '/') {
+            endpoint = "/" + endpoint;
+        }
+
+        fetch(endpoint).then([request](json::value result) {
+            return request.reply(status_of(result), result);
+        });
+    }
+
+public:
+    PokeapiSidecar(const std::string& listen_uri = "http://127.0.0.1:8080/api/v2",
+                   std::chrono::seconds ttl = std::chrono::hours(24),
+                   const refresh_options& refresh = refresh_options(),
+                   const std::string& upstream_base = "https://pokeapi.co/api/v2")
+        : upstream(upstream_base), listener(utility::conversions::to_string_t(listen_uri)), ttl(ttl), refresh(refresh) {
+        listener.support(methods::GET, [this](http_request request) { handle_get(request); });
+    }
+
+    ~PokeapiSidecar() {
+        stop_scheduler();
+        try {
+            listener.close().wait();
+        } catch (...) {
+        }
+        drain().wait();
+    }
+
+    pplx::task<void> open() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = false;
+        }
+        if (!scheduler.joinable()) {
+            scheduler = std::thread([this]() { schedule_refreshes(); });
+        }
+        return listener.open();
+    }
+
+    // Completes once the listener is closed and every upstream fetch has
+    // finished. Keep the sidecar alive until then.
+    pplx::task<void> close() {
+        stop_scheduler();
+        return listener.close().then([this](pplx::task<void> closed) {
+            return drain().then([closed]() {
+                closed.get();
+            });
+        });
+    }
+
+    // Serve misses from a snapshot before going upstream. Entries age from
+    // the time the snapshot was written.
+    void use_snapshot(const std::string& path) {
+        std::unique_ptr<PokeapiSnapshot> loaded(new PokeapiSnapshot(path));
+        std::lock_guard<std::mutex> guard(lock);
+        snapshot = std::move(loaded);
+    }
+
+    // Write every cached resource, without cached 404s, to a snapshot file
+    void save_snapshot(const std::string& path) {
+        std::map<std::string, json::value> resources;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (const auto& entry : cache) {
+                if (entry.second.status == status_codes::OK) {
+                    resources[entry.first] = entry.second.body;
+                }
+            }
+        }
+        PokeapiSnapshot::write(path, resources);
+    }
+
+    size_t cached_count() {
+        std::lock_guard<std::mutex> guard(lock);
+        return cache.size();
+    }
+};
+
+#endif
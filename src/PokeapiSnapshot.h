@@ -0,0 +1,616 @@
+#ifndef POKEAPI_SNAPSHOT_H
+#define POKEAPI_SNAPSHOT_H
+
+#include <cpprest/json.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace web;
+
+// Read-only binary snapshot of cached resources.
+//
+// The file is mmapped and read in place, so opening it costs one syscall no
+// matter how many resources it holds, and every process that opens the same
+// file shares its pages. Layout (native byte order, all sections 8-aligned):
+//
+//   header
+//   string table    string_count x { uint32 offset, uint32 length }
+//   string data     interned UTF-8 bytes, each string stored once
+//   resource table  resource_count x { uint32 endpoint, uint32 root }, sorted by endpoint
+//   nodes           node_count x node; containers point at their contiguous children
+class PokeapiSnapshot {
+public:
+    static const uint32_t format_version = 1;
+
+    enum node_type : uint32_t { null_node, bool_node, int_node, uint_node, double_node, string_node, array_node, object_node };
+
+private:
+    static const uint32_t no_key = 0xFFFFFFFF;
+    static const uint32_t byte_order_mark = 0x01020304;
+
+    struct header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t string_count;
+        uint32_t resource_count;
+        uint64_t node_count;
+        uint64_t created;
+        uint64_t string_table_offset;
+        uint64_t string_data_offset;
+        uint64_t resource_table_offset;
+        uint64_t node_offset;
+    };
+
+    struct string_entry {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct resource_entry {
+        uint32_t endpoint;
+        uint32_t root;
+    };
+
+    struct node {
+        uint32_t type;
+        uint32_t key;
+        uint32_t count;
+        uint32_t reserved;
+        uint64_t payload;
+    };
+
+    const char* data = nullptr;
+    size_t data_size = 0;
+    const header* head = nullptr;
+    const string_entry* strings = nullptr;
+    const char* string_data = nullptr;
+    const resource_entry* resources = nullptr;
+    const node* nodes = nullptr;
+    uint64_t string_data_size = 0;
+
+    static void corrupt() {
+        throw std::runtime_error("Corrupt snapshot");
+    }
+
+    // True when count items of the given size starting at offset lie within
+    // limit; written so that no step can overflow
+    static bool fits(uint64_t offset, uint64_t count, uint64_t size, uint64_t limit) {
+        return offset <= limit && count <= (limit - offset) / size;
+    }
+
+    const string_entry& string_entry_at(uint32_t id) const {
+        if (id >= head->string_count) {
+            corrupt();
+        }
+        const string_entry& entry = strings[id];
+        if (!fits(entry.offset, entry.length, 1, string_data_size)) {
+            corrupt();
+        }
+        return entry;
+    }
+
+    std::string string_at(uint32_t id) const {
+        const string_entry& entry = string_entry_at(id);
+        return std::string(string_data + entry.offset, entry.length);
+    }
+
+    int compare_string(uint32_t id, const std::string& other) const {
+        const string_entry& entry = string_entry_at(id);
+        size_t length = entry.length;
+        int result = std::memcmp(string_data + entry.offset, other.data(), std::min(length, other.size()));
+        if (result != 0) {
+            return result;
+        }
+        return length < other.size() ? -1 : (length > other.size() ? 1 : 0);
+    }
+
+    const node* node_at(uint64_t index) const {
+        if (index >= head->node_count) {
+            corrupt();
+        }
+        return nodes + index;
+    }
+
+    // Children always follow their parent, which also rules out cycles
+    const node* children_of(const node* entry) const {
+        uint64_t index = static_cast<uint64_t>(entry - nodes);
+        if (entry->payload <= index || !fits(entry->payload, entry->count, 1, head->node_count)) {
+            corrupt();
+        }
+        return nodes + entry->payload;
+    }
+
+    static uint64_t align(uint64_t offset) {
+        return (offset + 7) & ~uint64_t(7);
+    }
+
+    void close() {
+        if (data) {
+            munmap(const_cast<char*>(data), data_size);
+        }
+        data = nullptr;
+        data_size = 0;
+    }
+
+    // Reserves each container's children as one contiguous block of nodes
+    // before filling them in.
+    class writer {
+    public:
+        std::vector<std::string> string_list;
+        std::unordered_map<std::string, uint32_t> string_ids;
+        std::vector<node> node_list;
+
+        uint32_t intern(const std::string& text) {
+            auto found = string_ids.find(text);
+            if (found != string_ids.end()) {
+                return found->second;
+            }
+            uint32_t id = static_cast<uint32_t>(string_list.size());
+            string_list.push_back(text);
+            string_ids[text] = id;
+            return id;
+        }
+
+        uint32_t add(const json::value& value) {
+            uint32_t index = static_cast<uint32_t>(node_list.size());
+            node_list.push_back(node{null_node, no_key, 0, 0, 0});
+            fill(index, value);
+            return index;
+        }
+
+        void fill(uint32_t index, const json::value& value) {
+            node entry = node_list[index];
+            switch (value.type()) {
+            case json::value::Boolean:
+                entry.type = bool_node;
+                entry.payload = value.as_bool() ? 1 : 0;
+                break;
+            case json::value::Number: {
+                const json::number& number = value.as_number();
+                if (number.is_int64()) {
+                    entry.type = int_node;
+                    int64_t integer = number.to_int64();
+                    std::memcpy(&entry.payload, &integer, sizeof(integer));
+                } else if (number.is_uint64()) {
+                    entry.type = uint_node;
+                    entry.payload = number.to_uint64();
+                } else {
+                    entry.type = double_node;
+                    double real = number.to_double();
+                    std::memcpy(&entry.payload, &real, sizeof(real));
+                }
+                break;
+            }
+            case json::value::String:
+                entry.type = string_node;
+                entry.payload = intern(utility::conversions::to_utf8string(value.as_string()));
+                break;
+            case json::value::Array: {
+                const json::array& items = value.as_array();
+                entry.type = array_node;
+                entry.count = static_cast<uint32_t>(items.size());
+                entry.payload = node_list.size();
+                node_list.resize(node_list.size() + items.size(), node{null_node, no_key, 0, 0, 0});
+                uint32_t child = static_cast<uint32_t>(entry.payload);
+                for (const auto& item : items) {
+                    fill(child++, item);
+                }
+                break;
+            }
+            case json::value::Object: {
+                const json::object& members = value.as_object();
+                entry.type = object_node;
+                entry.count = static_cast<uint32_t>(members.size());
+                entry.payload = node_list.size();
+                node_list.resize(node_list.size() + members.size(), node{null_node, no_key, 0, 0, 0});
+                uint32_t child = static_cast<uint32_t>(entry.payload);
+                for (const auto& member : members) {
+                    node_list[child].key = intern(utility::conversions::to_utf8string(member.first));
+                    fill(child++, member.second);
+                }
+                break;
+            }
+            default:
+                break;
+            }
+            node_list[index] = entry;
+        }
+    };
+
+public:
+    // In-place view of one node; valid while its snapshot is open.
+    class node_view {
+    private:
+        const PokeapiSnapshot* owner;
+        const node* entry;
+
+        static void type_error(const char* expected) {
+            throw std::runtime_error(std::string("snapshot node is not ") + expected);
+        }
+
+    public:
+        node_view(const PokeapiSnapshot* owner, const node* entry) : owner(owner), entry(entry) {}
+
+        node_type type() const { return static_cast<node_type>(entry->type); }
+        bool is_null() const { return entry->type == null_node; }
+        bool is_object() const { return entry->type == object_node; }
+        bool is_array() const { return entry->type == array_node; }
+        bool is_string() const { return entry->type == string_node; }
+        bool is_bool() const { return entry->type == bool_node; }
+
+        bool is_number() const {
+            return entry->type == int_node || entry->type == uint_node || entry->type == double_node;
+        }
+
+        size_t size() const {
+            return (is_array() || is_object()) ? entry->count : 0;
+        }
+
+        bool as_bool() const {
+            if (!is_bool()) {
+                type_error("a boolean");
+            }
+            return entry->payload != 0;
+        }
+
+        // Unsigned values are returned only when they fit
+        int64_t as_integer() const {
+            if (entry->type == uint_node && entry->payload <= uint64_t(INT64_MAX)) {
+                return static_cast<int64_t>(entry->payload);
+            }
+            if (entry->type != int_node) {
+                type_error("an integer");
+            }
+            int64_t integer;
+            std::memcpy(&integer, &entry->payload, sizeof(integer));
+            return integer;
+        }
+
+        double as_double() const {
+            if (entry->type == int_node) {
+                return static_cast<double>(as_integer());
+            }
+            if (entry->type == uint_node) {
+                return static_cast<double>(entry->payload);
+            }
+            if (entry->type != double_node) {
+                type_error("a number");
+            }
+            double real;
+            std::memcpy(&real, &entry->payload, sizeof(real));
+            return real;
+        }
+
+        // Interned string id, shared by every equal string in the snapshot;
+        // 0xFFFFFFFF for other nodes
+        uint32_t string_id() const {
+            if (!is_string()) {
+                return no_key;
+            }
+            return static_cast<uint32_t>(entry->payload);
+        }
+
+        std::string as_string() const {
+            if (!is_string()) {
+                type_error("a string");
+            }
+            return owner->string_at(string_id());
+        }
+
+        std::string key() const {
+            return entry->key == no_key ? std::string() : owner->string_at(entry->key);
+        }
+
+        node_view at(size_t index) const {
+            if (index >= size()) {
+                throw std::out_of_range("snapshot node index out of range");
+            }
+            return node_view(owner, owner->children_of(entry) + index);
+        }
+
+        bool has_field(const std::string& name) const {
+            return find_field(name) != nullptr;
+        }
+
+        node_view at(const std::string& name) const {
+            const node* found = find_field(name);
+            if (!found) {
+                throw std::out_of_range("snapshot object has no field " + name);
+            }
+            return node_view(owner, found);
+        }
+
+        json::value to_json() const {
+            switch (entry->type) {
+            case bool_node:
+                return json::value::boolean(as_bool());
+            case int_node:
+                return json::value::number(as_integer());
+            case uint_node:
+                return json::value::number(entry->payload);
+            case double_node:
+                return json::value::number(as_double());
+            case string_node:
+                return json::value::string(utility::conversions::to_string_t(as_string()));
+            case array_node: {
+                owner->children_of(entry);
+                json::value result = json::value::array(entry->count);
+                for (size_t i = 0; i < entry->count; i++) {
+                    result[i] = at(i).to_json();
+                }
+                return result;
+            }
+            case object_node: {
+                json::value result = json::value::object();
+                for (size_t i = 0; i < entry->count; i++) {
+                    node_view member = at(i);
+                    result[utility::conversions::to_string_t(member.key())] = member.to_json();
+                }
+                return result;
+            }
+            default:
+                return json::value::null();
+            }
+        }
+
+    private:
+        const node* find_field(const std::string& name) const {
+            if (!is_object()) {
+                return nullptr;
+            }
+            const node* child = owner->children_of(entry);
+            for (uint32_t i = 0; i < entry->count; i++, child++) {
+                if (owner->compare_string(child->key, name) == 0) {
+                    return child;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    explicit PokeapiSnapshot(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open snapshot " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(header)) {
+            ::close(fd);
+            throw std::runtime_error("Snapshot too small: " + path);
+        }
+        data_size = static_cast<size_t>(info.st_size);
+        void* mapped = mmap(nullptr, data_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            data_size = 0;
+            throw std::runtime_error("Cannot map snapshot " + path);
+        }
+        data = static_cast<const char*>(mapped);
+
+        head = reinterpret_cast<const header*>(data);
+        if (std::memcmp(head->magic, "PKSNAP\0\0", 8) != 0 || head->byte_order != byte_order_mark) {
+            close();
+            throw std::runtime_error("Not a snapshot: " + path);
+        }
+        if (head->version != format_version) {
+            uint32_t version = head->version;
+            close();
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(version));
+        }
+        // Only section bounds are checked here, so opening stays cheap; ids
+        // and child indices are checked as they are read
+        uint64_t size = data_size;
+        bool valid = head->string_table_offset % 8 == 0 && head->resource_table_offset % 8 == 0 &&
+                     head->node_offset % 8 == 0 &&
+                     head->string_table_offset >= sizeof(header) &&
+                     fits(head->string_table_offset, head->string_count, sizeof(string_entry), size) &&
+                     head->string_data_offset >= head->string_table_offset + uint64_t(head->string_count) * sizeof(string_entry) &&
+                     head->resource_table_offset >= head->string_data_offset &&
+                     fits(head->resource_table_offset, head->resource_count, sizeof(resource_entry), size) &&
+                     head->node_offset >= head->resource_table_offset + uint64_t(head->resource_count) * sizeof(resource_entry) &&
+                     fits(head->node_offset, head->node_count, sizeof(node), size);
+        if (!valid) {
+            close();
+            throw std::runtime_error("Truncated or corrupt snapshot: " + path);
+        }
+        strings = reinterpret_cast<const string_entry*>(data + head->string_table_offset);
+        string_data = data + head->string_data_offset;
+        string_data_size = head->resource_table_offset - head->string_data_offset;
+        resources = reinterpret_cast<const resource_entry*>(data + head->resource_table_offset);
+        nodes = reinterpret_cast<const node*>(data + head->node_offset);
+    }
+
+    ~PokeapiSnapshot() {
+        close();
+    }
+
+    PokeapiSnapshot(const PokeapiSnapshot&) = delete;
+    PokeapiSnapshot& operator=(const PokeapiSnapshot&) = delete;
+
+    size_t size() const {
+        return head->resource_count;
+    }
+
+    // Seconds since the epoch when the snapshot was written
+    std::time_t created() const {
+        return static_cast<std::time_t>(head->created);
+    }
+
+    std::vector<std::string> endpoints() const {
+        std::vector<std::string> result;
+        result.reserve(head->resource_count);
+        for (uint32_t i = 0; i < head->resource_count; i++) {
+            result.push_back(string_at(resources[i].endpoint));
+        }
+        return result;
+    }
+
+    bool contains(const std::string& endpoint) const {
+        return find_resource(endpoint) != nullptr;
+    }
+
+    // In-place access to a resource; throws std::out_of_range if missing
+    node_view find(const std::string& endpoint) const {
+        const resource_entry* found = find_resource(endpoint);
+        if (!found) {
+            throw std::out_of_range("Endpoint not in snapshot: " + endpoint);
+        }
+        return node_view(this, node_at(found->root));
+    }
+
+    // Materialized copy of a resource, or the usual error object if missing
+    json::value get(const std::string& endpoint) const {
+        const resource_entry* found = find_resource(endpoint);
+        if (!found) {
+            json::value error_obj;
+            error_obj[U("error")] = json::value::string(
+                U("Not in snapshot: ") + utility::conversions::to_string_t(endpoint));
+            error_obj[U("success")] = json::value::boolean(false);
+            return error_obj;
+        }
+        return node_view(this, node_at(found->root)).to_json();
+    }
+
+    // Converts cached JSON resources, keyed by endpoint, into a snapshot file
+    static void write(const std::string& path, const std::map<std::string, json::value>& resources) {
+        writer out;
+        std::vector<resource_entry> table;
+        table.reserve(resources.size());
+        for (const auto& resource : resources) {
+            uint32_t endpoint = out.intern(resource.first);
+            table.push_back(resource_entry{endpoint, out.add(resource.second)});
+        }
+        // std::map iterates in byte order, so the table is already sorted
+
+        header head;
+        std::memset(&head, 0, sizeof(head));
+        std::memcpy(head.magic, "PKSNAP\0\0", 8);
+        head.version = format_version;
+        head.byte_order = byte_order_mark;
+        head.string_count = static_cast<uint32_t>(out.string_list.size());
+        head.resource_count = static_cast<uint32_t>(table.size());
+        head.node_count = out.node_list.size();
+        head.created = static_cast<uint64_t>(std::time(nullptr));
+
+        std::vector<string_entry> string_table;
+        string_table.reserve(out.string_list.size());
+        uint64_t string_bytes = 0;
+        for (const auto& text : out.string_list) {
+            string_table.push_back(string_entry{static_cast<uint32_t>(string_bytes), static_cast<uint32_t>(text.size())});
+            string_bytes += text.size();
+        }
+        if (string_bytes > 0xFFFFFFFF) {
+            throw std::runtime_error("Snapshot string data exceeds 4 GiB");
+        }
+
+        head.string_table_offset = align(sizeof(header));
+        head.string_data_offset = align(head.string_table_offset + string_table.size() * sizeof(string_entry));
+        head.resource_table_offset = align(head.string_data_offset + string_bytes);
+        head.node_offset = align(head.resource_table_offset + table.size() * sizeof(resource_entry));
+
+        // Written beside the target and renamed over it, so processes that
+        // already map the old file keep reading its inode untouched.
+        // The name is unique, so concurrent writers never share a temporary.
+        std::vector<char> name(path.begin(), path.end());
+        const char suffix[] = ".XXXXXX";
+        name.insert(name.end(), suffix, suffix + sizeof(suffix));
+        int created = mkstemp(name.data());
+        if (created < 0) {
+            throw std::runtime_error("Cannot create snapshot beside " + path);
+        }
+        std::string temporary(name.data());
+        bool opened = fchmod(created, 0644) == 0;
+        ::close(created);
+        std::ofstream file;
+        if (opened) {
+            file.open(temporary, std::ios::binary | std::ios::trunc);
+        }
+        if (!file) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Cannot write snapshot " + temporary);
+        }
+        auto pad_to = [&file](uint64_t offset) {
+            static const char zeros[8] = {0};
+            uint64_t position = static_cast<uint64_t>(file.tellp());
+            file.write(zeros, static_cast<std::streamsize>(offset - position));
+        };
+
+        file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+        pad_to(head.string_table_offset);
+        file.write(reinterpret_cast<const char*>(string_table.data()), string_table.size() * sizeof(string_entry));
+        pad_to(head.string_data_offset);
+        for (const auto& text : out.string_list) {
+            file.write(text.data(), text.size());
+        }
+        pad_to(head.resource_table_offset);
+        file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(resource_entry));
+        pad_to(head.node_offset);
+        file.write(reinterpret_cast<const char*>(out.node_list.data()), out.node_list.size() * sizeof(node));
+        file.close();
+        if (!file) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed writing snapshot " + temporary);
+        }
+
+        int fd = ::open(temporary.c_str(), O_RDONLY);
+        bool synced = fd >= 0 && fsync(fd) == 0;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (!synced) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed writing snapshot " + temporary);
+        }
+
+        // Read every resource back before the file replaces anything
+        bool verified;
+        try {
+            PokeapiSnapshot written(temporary);
+            verified = written.size() == resources.size();
+            for (auto resource = resources.begin(); verified && resource != resources.end(); ++resource) {
+                verified = written.get(resource->first) == resource->second;
+            }
+        } catch (const std::exception&) {
+            verified = false;
+        }
+        if (!verified) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Snapshot did not read back as written: " + temporary);
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed replacing snapshot " + path);
+        }
+    }
+
+private:
+    const resource_entry* find_resource(const std::string& endpoint) const {
+        const resource_entry* first = resources;
+        const resource_entry* last = resources + head->resource_count;
+        const resource_entry* found = std::lower_bound(first, last, endpoint,
+            [this](const resource_entry& entry, const std::string& key) {
+                return compare_string(entry.endpoint, key) < 0;
+            });
+        if (found != last && compare_string(found->endpoint, endpoint) == 0) {
+            return found;
+        }
+        return nullptr;
+    }
+};
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef POKEAPI_SYNC_H
+#define POKEAPI_SYNC_H
+
+#include "Pokeapi.h"
+#include "PokeapiSnapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Settings for PokeapiMirror::sync.
+// With trust_counts, a family whose list count matches the local copy is not
+// listed in full, so only the revalidation sample is fetched for it.
+// revalidate_fraction of the unchanged resources in each family are fetched
+// again and compared. call is passed to every upstream request, so its token
+// cancels a running sync.
+struct sync_options {
+    bool trust_counts = false;
+    double revalidate_fraction = 0.05;
+    size_t concurrency = 8;
+    call_options call;
+};
+
+// One entry of the change log returned by a sync. cancelled is logged once,
+// for the family the sync stopped in.
+struct sync_change {
+    enum kind_type { added, updated, removed, failed, cancelled };
+
+    kind_type kind;
+    std::string family;
+    std::string endpoint;
+};
+
+// Local mirror of pokeapi resources, keyed by endpoint ("/pokemon/25").
+// sync() brings it up to date by comparing each family's list with the local
+// copy and fetching only what is new, plus a sample of what exists, instead
+// of re-crawling everything. Persist it between runs as a snapshot.
+// Not safe to sync from several threads at once.
+class PokeapiMirror {
+private:
+    Pokeapi api;
+    std::map<std::string, json::value> store;
+    std::mt19937 random{std::random_device{}()};
+
+    static bool is_error(const json::value& result) {
+        return result.has_field(U("success")) && !result.at(U("success")).as_bool();
+    }
+
+    // The error object a call returns when its token was cancelled
+    static bool is_cancelled(const json::value& result) {
+        return is_error(result) && result.has_field(U("error")) && result.at(U("error")).is_string() &&
+               result.at(U("error")).as_string() == U("Cancelled");
+    }
+
+    // "https://pokeapi.co/api/v2/pokemon/25/" -> "/pokemon/25"
+    static std::string endpoint_from_url(const std::string& url) {
+        std::string endpoint = url;
+        size_t base = endpoint.find("/api/v2/");
+        if (base != std::string::npos) {
+            endpoint = endpoint.substr(base + 7);
+        }
+        while (endpoint.size() > 1 && endpoint.back() == '/') {
+            endpoint.pop_back();
+        }
+        return endpoint;
+    }
+
+    std::set<std::string> local_endpoints(const std::string& family) const {
+        std::set<std::string> result;
+        std::string prefix = "/" + family + "/";
+        for (auto it = store.lower_bound(prefix); it != store.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            if (it->first.find_first_of("/?", prefix.size()) == std::string::npos) {
+                result.insert(it->first);
+            }
+        }
+        return result;
+    }
+
+    // Fetches endpoints at most options.concurrency at a time; stops
+    // starting batches once the token is cancelled
+    std::vector<std::pair<std::string, json::value>> fetch_all(const std::vector<std::string>& endpoints,
+                                                               const sync_options& options) {
+        std::vector<std::pair<std::string, json::value>> result;
+        size_t batch = std::max<size_t>(1, options.concurrency);
+        for (size_t start = 0; start < endpoints.size(); start += batch) {
+            if (options.call.token.is_canceled()) {
+                break;
+            }
+            std::vector<pplx::task<json::value>> tasks;
+            size_t end = std::min(endpoints.size(), start + batch);
+            for (size_t i = start; i < end; i++) {
+                tasks.push_back(api.get_resource(endpoints[i], options.call));
+            }
+            auto bodies = pplx::when_all(tasks.begin(), tasks.end()).get();
+            for (size_t i = start; i < end; i++) {
+                result.emplace_back(endpoints[i], bodies[i - start]);
+            }
+        }
+        return result;
+    }
+
+    // Collects every url in a family's list, following "next" when the
+    // server caps the page size. Returns false unless the pages add up to
+    // the count they report, so a short list never removes anything.
+    // Every page followed adds at least one url, so stopping at count + 1
+    // pages bounds a server whose "next" never runs out.
+    bool list_family(const std::string& family, int count, const sync_options& options, std::set<std::string>& remote) {
+        std::string page = "/" + family + "?limit=" + std::to_string(std::max(count, 1)) + "&offset=0";
+        size_t listed = 0;
+        size_t pages_left = static_cast<size_t>(std::max(count, 0)) + 1;
+        while (!page.empty() && pages_left-- > 0) {
+            json::value list = api.get_resource(page, options.call).get();
+            if (is_error(list) || !list.has_field(U("results")) || !list.has_field(U("count"))) {
+                return false;
+            }
+            const json::array& results = list.at(U("results")).as_array();
+            for (const auto& item : results) {
+                remote.insert(endpoint_from_url(utility::conversions::to_utf8string(item.at(U("url")).as_string())));
+            }
+            listed += results.size();
+            count = list.at(U("count")).as_integer();
+            if (count < 0) {
+                return false;
+            }
+
+            page.clear();
+            if (listed < static_cast<size_t>(count) && list.has_field(U("next")) && list.at(U("next")).is_string() &&
+                results.size() > 0) {
+                page = endpoint_from_url(utility::conversions::to_utf8string(list.at(U("next")).as_string()));
+            }
+        }
+        return listed == static_cast<size_t>(count) && remote.size() == listed;
+    }
+
+    // Returns false, after logging it, if the sync was cancelled
+    bool sync_family(const std::string& family, const sync_options& options, std::vector<sync_change>& changes) {
+        auto stop = [&]() {
+            changes.push_back(sync_change{sync_change::cancelled, family, "/" + family});
+            return false;
+        };
+        if (options.call.token.is_canceled()) {
+            return stop();
+        }
+        std::set<std::string> local = local_endpoints(family);
+
+        json::value head = api.get_resource("/" + family + "?limit=1", options.call).get();
+        if (options.call.token.is_canceled()) {
+            return stop();
+        }
+        if (is_error(head) || !head.has_field(U("count"))) {
+            changes.push_back(sync_change{sync_change::failed, family, "/" + family});
+            return true;
+        }
+        int count = head.at(U("count")).as_integer();
+
+        std::vector<std::string> missing;
+        std::vector<std::string> existing(local.begin(), local.end());
+        if (!options.trust_counts || count != static_cast<int>(local.size())) {
+            std::set<std::string> remote;
+            if (!list_family(family, count, options, remote)) {
+                if (options.call.token.is_canceled()) {
+                    return stop();
+                }
+                changes.push_back(sync_change{sync_change::failed, family, "/" + family});
+                return true;
+            }
+
+            existing.clear();
+            for (const auto& endpoint : remote) {
+                if (local.count(endpoint)) {
+                    existing.push_back(endpoint);
+                } else {
+                    missing.push_back(endpoint);
+                }
+            }
+            for (const auto& endpoint : local) {
+                if (!remote.count(endpoint)) {
+                    store.erase(endpoint);
+                    changes.push_back(sync_change{sync_change::removed, family, endpoint});
+                }
+            }
+        }
+
+        for (const auto& fetched : fetch_all(missing, options)) {
+            if (is_cancelled(fetched.second)) {
+                continue;
+            }
+            if (is_error(fetched.second)) {
+                changes.push_back(sync_change{sync_change::failed, family, fetched.first});
+                continue;
+            }
+            store[fetched.first] = fetched.second;
+            changes.push_back(sync_change{sync_change::added, family, fetched.first});
+        }
+        if (options.call.token.is_canceled()) {
+            return stop();
+        }
+
+        size_t sample = static_cast<size_t>(std::ceil(existing.size() * std::max(0.0, std::min(1.0, options.revalidate_fraction))));
+        std::shuffle(existing.begin(), existing.end(), random);
+        existing.resize(sample);
+        for (const auto& fetched : fetch_all(existing, options)) {
+            if (is_cancelled(fetched.second)) {
+                continue;
+            }
+            if (is_error(fetched.second)) {
+                changes.push_back(sync_change{sync_change::failed, family, fetched.first});
+                continue;
+            }
+            if (store[fetched.first] != fetched.second) {
+                store[fetched.first] = fetched.second;
+                changes.push_back(sync_change{sync_change::updated, family, fetched.first});
+            }
+        }
+        if (options.call.token.is_canceled()) {
+            return stop();
+        }
+        return true;
+    }
+
+public:
+    explicit PokeapiMirror(const Pokeapi& api = Pokeapi()) : api(api) {}
+
+    // Every resource family with a list endpoint
+    static const std::vector<std::string>& families() {
+        static const std::vector<std::string> all = {
+            "ability", "berry", "berry-firmness", "berry-flavor", "characteristic", "contest-effect",
+            "contest-type", "egg-group", "encounter-condition", "encounter-condition-value",
+            "encounter-method", "evolution-chain", "evolution-trigger", "gender", "generation",
+            "growth-rate", "item", "item-attribute", "item-category", "item-fling-effect", "item-pocket",
+            "language", "location", "location-area", "machine", "move", "move-ailment",
+            "move-battle-style", "move-category", "move-damage-class", "move-learn-method",
+            "move-target", "nature", "pal-park-area", "pokeathlon-stat", "pokedex", "pokemon",
+            "pokemon-color", "pokemon-form", "pokemon-habitat", "pokemon-shape", "pokemon-species",
+            "region", "stat", "super-contest-effect", "type", "version", "version-group"
+        };
+        return all;
+    }
+
+    const std::map<std::string, json::value>& resources() const {
+        return store;
+    }
+
+    // Replace local state with the contents of a snapshot
+    void load(const std::string& path) {
+        PokeapiSnapshot snapshot(path);
+        std::map<std::string, json::value> loaded;
+        for (const auto& endpoint : snapshot.endpoints()) {
+            loaded[endpoint] = snapshot.get(endpoint);
+        }
+        store.swap(loaded);
+    }
+
+    void save(const std::string& path) const {
+        PokeapiSnapshot::write(path, store);
+    }
+
+    pplx::task<std::vector<sync_change>> sync(const sync_options& options = sync_options()) {
+        return sync(families(), options);
+    }
+
+    // Families that cannot be listed are reported as failed and left untouched
+    pplx::task<std::vector<sync_change>> sync(const std::vector<std::string>& selected,
+                                              const sync_options& options = sync_options()) {
+        return pplx::create_task([this, selected, options]() {
+            std::vector<sync_change> changes;
+            for (const auto& family : selected) {
+                if (!sync_family(family, options, changes)) {
+                    break;
+                }
+            }
+            return changes;
+        });
+    }
+
+    static json::value change_log(const std::vector<sync_change>& changes) {
+        static const char* kinds[] = {"added", "updated", "removed", "failed", "cancelled"};
+        json::value log = json::value::array(changes.size());
+        for (size_t i = 0; i < changes.size(); i++) {
+            log[i][U("change")] = json::value::string(utility::conversions::to_string_t(kinds[changes[i].kind]));
+            log[i][U("family")] = json::value::string(utility::conversions::to_string_t(changes[i].family));
+            log[i][U("endpoint")] = json::value::string(utility::conversions::to_string_t(changes[i].endpoint));
+        }
+        return log;
+    }
+};
+
+#endif